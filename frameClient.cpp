@@ -0,0 +1,89 @@
+#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "frameServer.h"
+
+/* Hodeløs referanse klient for frame serveren.
+   Kobler seg til ringen, leser siste frame uten å kopiere pikslene og
+   skriver ut hvor lang tid det tok fra spillet publiserte til vi så framet.
+
+   Bruk: ./frameClient [navn] [antall sekunder]
+*/
+
+int main(int argc, char* argv[]){
+    const char* name = argc > 1 ? argv[1] : FRAME_SERVER_DEFAULT_NAME;
+    const double run_seconds = argc > 2 ? atof(argv[2]) : 10.0;
+
+    FrameClient client = {};
+    while (!frame_client_attach(&client, name)){
+        std::cerr << "Waiting for frame server " << name << "...\n";
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    std::cout << "Attached to " << name << " ("
+              << client.header->width << "x" << client.header->height << ")\n";
+
+    uint64_t last_frame = 0;
+    uint64_t frames = 0, dropped = 0, torn = 0;
+    uint64_t latency_min = UINT64_MAX, latency_max = 0, latency_sum = 0;
+    uint64_t checksum = 0;
+
+    const uint64_t start = frame_server_now_ns();
+    uint64_t report = start;
+    while (frame_server_now_ns() - start < run_seconds * 1e9){
+        FrameView view;
+        if (!frame_client_latest(&client, &view) || view.state.frame == last_frame){
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+
+        uint64_t latency = frame_server_now_ns() - view.state.timestamp_ns;
+
+        // Les pikslene der de ligger, som en opptaker eller bot ville gjort
+        uint64_t sum = 0;
+        for (size_t i = 0; i < view.width * view.height; ++i){
+            sum += view.data[i];
+        }
+        if (!frame_client_still_valid(&client, view)){
+            ++torn;
+            continue;
+        }
+        checksum ^= sum;
+
+        if (last_frame && view.state.frame > last_frame + 1){
+            dropped += view.state.frame - last_frame - 1;
+        }
+        last_frame = view.state.frame;
+
+        ++frames;
+        latency_sum += latency;
+        if (latency < latency_min) latency_min = latency;
+        if (latency > latency_max) latency_max = latency;
+
+        uint64_t now = frame_server_now_ns();
+        if (now - report >= 1000000000ull){
+            printf("frame %llu  score %u  lives %u  aliens %u  bullets %u  "
+                   "latency us min %.1f avg %.1f max %.1f  dropped %llu  torn %llu\n",
+                   (unsigned long long)view.state.frame,
+                   view.state.score, view.state.lives,
+                   view.state.num_aliens, view.state.num_bullets,
+                   latency_min / 1e3, latency_sum / 1e3 / frames, latency_max / 1e3,
+                   (unsigned long long)dropped, (unsigned long long)torn);
+            report = now;
+        }
+    }
+
+    if (frames){
+        printf("%llu frames, latency us min %.1f avg %.1f max %.1f, dropped %llu, torn %llu, checksum %llx\n",
+               (unsigned long long)frames,
+               latency_min / 1e3, latency_sum / 1e3 / frames, latency_max / 1e3,
+               (unsigned long long)dropped, (unsigned long long)torn,
+               (unsigned long long)checksum);
+    } else {
+        std::cout << "No frames received\n";
+    }
+
+    frame_client_detach(&client);
+    return 0;
+}
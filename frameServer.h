@@ -0,0 +1,274 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* =====================
+     FRAME SERVER
+   =====================
+   Delt minne ring med FRAME_SERVER_SLOTS ruter. Spillet rasteriserer
+   rett inn i en rute, så publisering er bare et par atomiske lagringer.
+   Lesere får en peker inn i ruten (ingen kopi) og sjekker etterpå at
+   ruten ikke ble skrevet over mens de leste den (seqlock).
+
+   slot.seq = 2f - 1 mens frame f skrives, 2f når den er ferdig.
+   header.latest = siste ferdige frame f, ligger i rute f % FRAME_SERVER_SLOTS.
+*/
+
+#define FRAME_SERVER_MAGIC   0x53494652u // "SIFR"
+#define FRAME_SERVER_VERSION 2
+#define FRAME_SERVER_SLOTS   4
+#define FRAME_SERVER_DEFAULT_NAME "/spaceinvaders"
+
+struct FrameState {
+    uint64_t frame;
+    uint64_t timestamp_ns;
+    uint32_t score;
+    uint32_t lives;
+    uint32_t num_aliens;
+    uint32_t num_bullets;
+};
+
+struct FrameSlot {
+    alignas(64) std::atomic<uint64_t> seq;
+    FrameState state;
+};
+
+struct FrameServerHeader {
+    std::atomic<uint32_t> magic; // settes sist, med release
+    uint32_t version;
+    uint32_t width, height;
+    uint32_t num_slots;
+    uint32_t pixels_offset;
+    int32_t owner_pid; // produsenten, for å kunne ta over etter en som krasjet
+    alignas(64) std::atomic<uint64_t> latest;
+    FrameSlot slots[FRAME_SERVER_SLOTS];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+        std::atomic<uint32_t>::is_always_lock_free,
+        "frame server needs lock free atomics");
+
+// Produsent (spillet)
+struct FrameServer {
+    const char* name;
+    FrameServerHeader* header;
+    uint32_t* pixels;
+    size_t size;
+    uint64_t frame;
+};
+
+// Leser (tilskuer, opptaker, bot ...)
+struct FrameClient {
+    const FrameServerHeader* header;
+    const uint32_t* pixels;
+    size_t size;
+};
+
+// Et frame som ligger i delt minne, gyldig til frame_client_still_valid sier nei
+struct FrameView {
+    uint64_t seq;
+    FrameState state;
+    size_t width, height;
+    const uint32_t* data;
+};
+
+inline uint64_t frame_server_now_ns(){
+    // steady_clock er CLOCK_MONOTONIC, så tiden kan sammenlignes mellom prosesser
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline size_t frame_server_frame_size(const FrameServerHeader* header){
+    return (size_t)header->width * header->height;
+}
+
+// Pid til produsenten som eier et eksisterende segment, 0 hvis headeren
+// ikke er ferdig (eller er fra en annen versjon) og eieren ikke kan vites
+inline int32_t frame_server_owner(const char* name){
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(FrameServerHeader)){
+        close(fd);
+        return 0;
+    }
+
+    void* memory = mmap(nullptr, sizeof(FrameServerHeader), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) return 0;
+
+    const FrameServerHeader* header = (const FrameServerHeader*)memory;
+    int32_t pid = 0;
+    if (header->magic.load(std::memory_order_acquire) == FRAME_SERVER_MAGIC &&
+            header->version == FRAME_SERVER_VERSION){
+        pid = header->owner_pid;
+    }
+    munmap(memory, sizeof(FrameServerHeader));
+    return pid;
+}
+
+// False med errno satt hvis det feiler. EEXIST betyr at navnet er i bruk av
+// en produsent som fortsatt kjører, segmenter etter en død produsent tas over.
+inline bool frame_server_create(FrameServer* server, const char* name, size_t width, size_t height){
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t pixels_offset = (sizeof(FrameServerHeader) + page - 1) / page * page;
+    const size_t size = pixels_offset + FRAME_SERVER_SLOTS * width * height * sizeof(uint32_t);
+
+    // O_EXCL: en annen instans med samme navn skal ikke få ringen sin skrevet over
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST){
+        // Bare ta over hvis eieren beviselig er borte, ellers er det en som
+        // kjører (eller holder på å sette opp headeren sin)
+        int32_t owner = frame_server_owner(name);
+        if (owner <= 0 || kill(owner, 0) == 0 || errno != ESRCH){
+            errno = EEXIST;
+            return false;
+        }
+        shm_unlink(name);
+        fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd < 0) return false;
+
+    if (ftruncate(fd, size) != 0){
+        close(fd);
+        shm_unlink(name);
+        return false;
+    }
+
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED){
+        shm_unlink(name);
+        return false;
+    }
+
+    FrameServerHeader* header = new (memory) FrameServerHeader;
+    header->magic.store(0, std::memory_order_relaxed);
+    header->version = FRAME_SERVER_VERSION;
+    header->width = width;
+    header->height = height;
+    header->num_slots = FRAME_SERVER_SLOTS;
+    header->pixels_offset = pixels_offset;
+    header->owner_pid = getpid();
+    header->latest.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < FRAME_SERVER_SLOTS; ++i){
+        header->slots[i].seq.store(0, std::memory_order_relaxed);
+        std::memset(&header->slots[i].state, 0, sizeof(FrameState));
+    }
+
+    // Magic sist, så lesere aldri ser en halvferdig header
+    header->magic.store(FRAME_SERVER_MAGIC, std::memory_order_release);
+
+    server->name = name;
+    server->header = header;
+    server->pixels = (uint32_t*)((uint8_t*)memory + pixels_offset);
+    server->size = size;
+    server->frame = 0;
+    return true;
+}
+
+inline void frame_server_destroy(FrameServer* server){
+    if (!server->header) return;
+    munmap(server->header, server->size);
+    shm_unlink(server->name);
+    server->header = nullptr;
+    server->pixels = nullptr;
+}
+
+// Gir neste rute å rasterisere inn i. Brukes som buffer.data for dette framet.
+inline uint32_t* frame_server_acquire(FrameServer* server){
+    uint64_t frame = ++server->frame;
+    FrameSlot& slot = server->header->slots[frame % FRAME_SERVER_SLOTS];
+    slot.seq.store(2 * frame - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return server->pixels + (frame % FRAME_SERVER_SLOTS) * frame_server_frame_size(server->header);
+}
+
+// Ferdig med å rasterisere ruten fra frame_server_acquire
+inline void frame_server_publish(FrameServer* server, const FrameState& state){
+    uint64_t frame = server->frame;
+    FrameSlot& slot = server->header->slots[frame % FRAME_SERVER_SLOTS];
+    slot.state = state;
+    slot.state.frame = frame;
+    slot.state.timestamp_ns = frame_server_now_ns();
+    slot.seq.store(2 * frame, std::memory_order_release);
+    server->header->latest.store(frame, std::memory_order_release);
+}
+
+inline bool frame_client_attach(FrameClient* client, const char* name){
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(FrameServerHeader)){
+        close(fd);
+        return false;
+    }
+
+    void* memory = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) return false;
+
+    // Magic lastes med acquire før resten av headeren leses
+    const FrameServerHeader* header = (const FrameServerHeader*)memory;
+    if (header->magic.load(std::memory_order_acquire) != FRAME_SERVER_MAGIC ||
+            header->version != FRAME_SERVER_VERSION ||
+            header->num_slots != FRAME_SERVER_SLOTS ||
+            header->pixels_offset + FRAME_SERVER_SLOTS * frame_server_frame_size(header) * sizeof(uint32_t)
+                > (size_t)st.st_size){
+        munmap(memory, st.st_size);
+        return false;
+    }
+
+    client->header = header;
+    client->pixels = (const uint32_t*)((const uint8_t*)memory + header->pixels_offset);
+    client->size = st.st_size;
+    return true;
+}
+
+inline void frame_client_detach(FrameClient* client){
+    if (!client->header) return;
+    munmap((void*)client->header, client->size);
+    client->header = nullptr;
+    client->pixels = nullptr;
+}
+
+// Siste ferdige frame, uten kopi av pikslene. False hvis ingen frame ennå,
+// eller hvis ruten ble skrevet over mens vi så på den.
+inline bool frame_client_latest(const FrameClient* client, FrameView* view){
+    const FrameServerHeader* header = client->header;
+    uint64_t frame = header->latest.load(std::memory_order_acquire);
+    if (frame == 0) return false;
+
+    const FrameSlot& slot = header->slots[frame % FRAME_SERVER_SLOTS];
+    uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq != 2 * frame) return false;
+
+    view->seq = seq;
+    view->state = slot.state;
+    view->width = header->width;
+    view->height = header->height;
+    view->data = client->pixels + (frame % FRAME_SERVER_SLOTS) * frame_server_frame_size(header);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.seq.load(std::memory_order_relaxed) == seq;
+}
+
+// Sjekk etter at view->data er lest: true hvis pikslene ikke ble skrevet over underveis
+inline bool frame_client_still_valid(const FrameClient* client, const FrameView& view){
+    const FrameSlot& slot = client->header->slots[(view.seq / 2) % FRAME_SERVER_SLOTS];
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.seq.load(std::memory_order_relaxed) == view.seq;
+}
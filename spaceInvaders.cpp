@@ -1,9 +1,35 @@
 #include <iostream>
 #include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include "frameServer.h"
 
 #define GAME_MAX_BULLETS 128
+#define GAME_NUM_BUNKERS 4
+#define BUNKER_WIDTH         22
+#define BUNKER_HEIGHT        16
+#define BUNKER_CRATER_WIDTH  8
+#define BUNKER_CRATER_HEIGHT 8
+#define SHADER_CACHE_DEFAULT_PATH "spaceInvaders.shadercache"
+#define SHADER_CACHE_MAGIC 0x43534953u // "SISC"
+
+#define AUTOPILOT_MOVES          3   // venstre, stå, høyre
+#define AUTOPILOT_ACTIONS        (2 * AUTOPILOT_MOVES) // med og uten skudd
+#define AUTOPILOT_ROLLOUTS       16  // utrullinger per handling per tick
+#define AUTOPILOT_HORIZON        112 // ticks, nok til at et skudd rekker helt opp
+#define AUTOPILOT_FIRE_INTERVAL  8   // ticks mellom skudd, som en spiller som trykker
+#define AUTOPILOT_REPORT_SECONDS 5
 
 enum AlienType: uint8_t{
     ALIEN_DEAD   = 0,
@@ -47,6 +73,12 @@ struct Bullet {
     int dir;
 };
 
+// Bunker med skade, én bitmaske per rad. Rad 0 er øverst, bit xi er kolonne xi.
+struct Bunker {
+    size_t x, y;
+    uint32_t rows[BUNKER_HEIGHT];
+};
+
 struct Game {
     size_t width, height; 
     size_t num_aliens;
@@ -54,6 +86,49 @@ struct Game {
     Alien* aliens;
     Player player;
     Bullet bullets[GAME_MAX_BULLETS];
+    Bunker bunkers[GAME_NUM_BUNKERS];
+};
+
+// Kladd for én autopilot tråd, allokert én gang så utrullingene ikke allokerer
+struct AutopilotWorker {
+    std::thread thread;
+    Alien* aliens;
+    uint8_t* death_counters;
+};
+
+struct Autopilot {
+    // Roten alle utrullinger starter fra, kopiert fra spillet hvert tick
+    Game game;
+    uint8_t* death_counters;
+    SpriteAnimation alien_animation[3];
+    size_t score;
+    size_t aliens_alive;
+    size_t fire_cooldown;
+
+    const Sprite* alien_death_sprite;
+    const Sprite* player_sprite;
+    const Sprite* bullet_sprite;
+
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+    uint64_t generation;
+    size_t workers_busy;
+    bool quit;
+    std::atomic<size_t> next_rollout;
+    std::atomic<size_t> action_score[AUTOPILOT_ACTIONS];
+
+    size_t num_workers;
+    AutopilotWorker* workers;
+    AutopilotWorker main_worker; // hovedtråden tar også utrullinger
+
+    int held_move;
+    uint64_t rollouts;
+    uint64_t report_rollouts;
+    std::atomic<uint64_t> ticks; // ticks utrullingene faktisk simulerte
+    uint64_t report_ticks;
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point report_time;
 };
 
 bool game_running = false; 
@@ -90,10 +165,66 @@ const char* fragment_shader_src =
     "    outColor = texture(buffer, TexCoord).rgb;\n"
     "}\n";
 
+/* =====================
+     BUNKERS
+   =====================
+   Bit xi i en rad er kolonne xi, så mønstrene under er speilvendt i forhold
+   til bildet. Begge er symmetriske, så det spiller ingen rolle.
+*/
+const uint32_t bunker_shape[BUNKER_HEIGHT] = {
+    0b0000111111111111110000, // ....@@@@@@@@@@@@@@....
+    0b0001111111111111111000, // ...@@@@@@@@@@@@@@@@...
+    0b0011111111111111111100, // ..@@@@@@@@@@@@@@@@@@..
+    0b0111111111111111111110, // .@@@@@@@@@@@@@@@@@@@@.
+    0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+    0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+    0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+    0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+    0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+    0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+    0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+    0b1111111111111111111111, // @@@@@@@@@@@@@@@@@@@@@@
+    0b1111111000000001111111, // @@@@@@@........@@@@@@@
+    0b1111110000000000111111, // @@@@@@..........@@@@@@
+    0b1111100000000000011111, // @@@@@............@@@@@
+    0b1111100000000000011111  // @@@@@............@@@@@
+};
+
+// Biten som skytes ut der et skudd treffer, midten ligger på treffpunktet
+const uint32_t bunker_crater[BUNKER_CRATER_HEIGHT] = {
+    0b10011001, // @..@@..@
+    0b00111100, // ..@@@@..
+    0b01111110, // .@@@@@@.
+    0b11111111, // @@@@@@@@
+    0b11111111, // @@@@@@@@
+    0b01111110, // .@@@@@@.
+    0b00111100, // ..@@@@..
+    0b10011001  // @..@@..@
+};
+
 void error_callback(int, const char*);
+bool bunker_bullet_hit(Bunker*, const Sprite&, const Bullet&);
+void bunker_carve(Bunker*, long, long);
+void buffer_draw_bunker(Buffer*, const Bunker&, uint32_t);
+void bench_bunkers(const Game&, const uint8_t*, const SpriteAnimation*, const Sprite&, const Sprite&, const Sprite&);
+void game_spawn_aliens(Game*, uint8_t*, const Sprite*, const Sprite&);
+void game_tick(Game*, uint8_t*, SpriteAnimation*, const Sprite&, const Sprite&, const Sprite&, int, bool, size_t*, size_t*);
 void key_callback(GLFWwindow*, int, int, int, int);
+Autopilot* autopilot_create(const Game&, const Sprite&, const Sprite&, const Sprite&);
+void autopilot_destroy(Autopilot*);
+void autopilot_tick(Autopilot*, GLFWwindow*, const Game&, const uint8_t*, const SpriteAnimation*, size_t, size_t);
+uint64_t autopilot_random(uint64_t*);
+void autopilot_worker_init(AutopilotWorker*, size_t);
+void autopilot_worker(Autopilot*, AutopilotWorker*);
+void autopilot_rollout(Autopilot*, AutopilotWorker*, size_t);
 void validate_shader(GLuint, const char*);
 bool validate_program(GLuint);
+bool program_binary_supported();
+GLuint program_compile();
+std::string program_cache_key();
+GLuint program_cache_load(const char*);
+void program_cache_store(GLuint, const char*);
+double ms_since(std::chrono::steady_clock::time_point);
 bool sprite_overlap_check(const Sprite&, size_t, size_t, const Sprite&, size_t, size_t);
 uint32_t rgb_to_uint32(uint8_t, uint8_t, uint8_t);
 void buffer_clear(Buffer*, uint32_t);
@@ -102,15 +233,304 @@ void buffer_draw_text(Buffer*, const Sprite&, const char*, size_t, size_t, uint3
 void buffer_draw_number(Buffer*, const Sprite&, const size_t, size_t, size_t, uint32_t);
 
 
-int main(){
+int main(int argc, char* argv[]){
+    const auto startup_start = std::chrono::steady_clock::now();
+
+    // --frame-server [navn] legger framene i delt minne for lokale lesere
+    // --autopilot lar en innebygd spiller styre, for soak testing
+    // --bench-bunkers måler tick tiden med GAME_MAX_BULLETS skudd mot bunkerne, uten vindu
+    const char* frame_server_name = nullptr;
+    bool use_autopilot = false;
+    bool run_bench_bunkers = false;
+    for (int i = 1; i < argc; ++i){
+        if (strcmp(argv[i], "--frame-server") == 0){
+            frame_server_name = (i + 1 < argc && argv[i + 1][0] == '/')? argv[++i]: FRAME_SERVER_DEFAULT_NAME;
+        } else if (strcmp(argv[i], "--autopilot") == 0){
+            use_autopilot = true;
+        } else if (strcmp(argv[i], "--bench-bunkers") == 0){
+            run_bench_bunkers = true;
+        }
+    }
+
+    // CPU bufferen
+    const size_t buffer_width  = 224;
+    const size_t buffer_height = 256; 
+    
+    uint32_t clear_color = rgb_to_uint32(0, 0, 0);
+
+    // Fylles av cpu_setup tråden under
+    Buffer buffer;
+    Sprite alien_sprites[6];
+    Sprite alien_death_sprite;
+    Sprite player_sprite;
+    Sprite text_spritesheet;
+    Sprite number_spritesheet;
+    Sprite bullet_sprite;
+    SpriteAnimation alien_animation[3];
+    Game game;
+    uint8_t* death_counters;
+
+    // CPU oppsettet (sprites, formasjon, buffer) kjøres på en egen tråd
+    // mens hovedtråden lager vinduet, konteksten og shaderne
+    double cpu_setup_ms = 0;
+    std::thread cpu_setup([&](){
+        const auto cpu_setup_start = std::chrono::steady_clock::now();
+
+        buffer.width  = buffer_width;
+        buffer.height = buffer_height;
+        buffer.data   = new uint32_t[buffer_width * buffer_height];
+        buffer_clear(&buffer, clear_color);
+
+        // Alien Sprite
+        alien_sprites[0].width = 8;
+        alien_sprites[0].height = 8;
+        alien_sprites[0].data = new uint8_t[64]
+        {
+            0,0,0,1,1,0,0,0, // ...@@...
+            0,0,1,1,1,1,0,0, // ..@@@@..
+            0,1,1,1,1,1,1,0, // .@@@@@@.
+            1,1,0,1,1,0,1,1, // @@.@@.@@
+            1,1,1,1,1,1,1,1, // @@@@@@@@
+            0,1,0,1,1,0,1,0, // .@.@@.@.
+            1,0,0,0,0,0,0,1, // @......@
+            0,1,0,0,0,0,1,0  // .@....@.
+        };
+
+        alien_sprites[1].width = 8;
+        alien_sprites[1].height = 8;
+        alien_sprites[1].data = new uint8_t[64]
+        {
+            0,0,0,1,1,0,0,0, // ...@@...
+            0,0,1,1,1,1,0,0, // ..@@@@..
+            0,1,1,1,1,1,1,0, // .@@@@@@.
+            1,1,0,1,1,0,1,1, // @@.@@.@@
+            1,1,1,1,1,1,1,1, // @@@@@@@@
+            0,0,1,0,0,1,0,0, // ..@..@..
+            0,1,0,1,1,0,1,0, // .@.@@.@.
+            1,0,1,0,0,1,0,1  // @.@..@.@
+        };
+
+        alien_sprites[2].width = 11;
+        alien_sprites[2].height = 8;
+        alien_sprites[2].data = new uint8_t[88]
+        {
+            0,0,1,0,0,0,0,0,1,0,0, // ..@.....@..
+            0,0,0,1,0,0,0,1,0,0,0, // ...@...@...
+            0,0,1,1,1,1,1,1,1,0,0, // ..@@@@@@@..
+            0,1,1,0,1,1,1,0,1,1,0, // .@@.@@@.@@.
+            1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@
+            1,0,1,1,1,1,1,1,1,0,1, // @.@@@@@@@.@
+            1,0,1,0,0,0,0,0,1,0,1, // @.@.....@.@
+            0,0,0,1,1,0,1,1,0,0,0  // ...@@.@@...
+        };
+
+        alien_sprites[3].width = 11;
+        alien_sprites[3].height = 8;
+        alien_sprites[3].data = new uint8_t[88]
+        {
+            0,0,1,0,0,0,0,0,1,0,0, // ..@.....@..
+            1,0,0,1,0,0,0,1,0,0,1, // @..@...@..@
+            1,0,1,1,1,1,1,1,1,0,1, // @.@@@@@@@.@
+            1,1,1,0,1,1,1,0,1,1,1, // @@@.@@@.@@@
+            1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@
+            0,1,1,1,1,1,1,1,1,1,0, // .@@@@@@@@@.
+            0,0,1,0,0,0,0,0,1,0,0, // ..@.....@..
+            0,1,0,0,0,0,0,0,0,1,0  // .@.......@.
+        };
+
+        alien_sprites[4].width = 12;
+        alien_sprites[4].height = 8;
+        alien_sprites[4].data = new uint8_t[96]
+        {
+            0,0,0,0,1,1,1,1,0,0,0,0, // ....@@@@....
+            0,1,1,1,1,1,1,1,1,1,1,0, // .@@@@@@@@@@.
+            1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
+            1,1,1,0,0,1,1,0,0,1,1,1, // @@@..@@..@@@
+            1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
+            0,0,0,1,1,0,0,1,1,0,0,0, // ...@@..@@...
+            0,0,1,1,0,1,1,0,1,1,0,0, // ..@@.@@.@@..
+            1,1,0,0,0,0,0,0,0,0,1,1  // @@........@@
+        };
+
+
+        alien_sprites[5].width = 12;
+        alien_sprites[5].height = 8;
+        alien_sprites[5].data = new uint8_t[96]
+        {
+            0,0,0,0,1,1,1,1,0,0,0,0, // ....@@@@....
+            0,1,1,1,1,1,1,1,1,1,1,0, // .@@@@@@@@@@.
+            1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
+            1,1,1,0,0,1,1,0,0,1,1,1, // @@@..@@..@@@
+            1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
+            0,0,1,1,1,0,0,1,1,1,0,0, // ..@@@..@@@..
+            0,1,1,0,0,1,1,0,0,1,1,0, // .@@..@@..@@.
+            0,0,1,1,0,0,0,0,1,1,0,0  // ..@@....@@..
+        };
+
+        alien_death_sprite.width = 13;
+        alien_death_sprite.height = 7;
+        alien_death_sprite.data = new uint8_t[91]
+        {
+            0,1,0,0,1,0,0,0,1,0,0,1,0, // .@..@...@..@.
+            0,0,1,0,0,1,0,1,0,0,1,0,0, // ..@..@.@..@..
+            0,0,0,1,0,0,0,0,0,1,0,0,0, // ...@.....@...
+            1,1,0,0,0,0,0,0,0,0,0,1,1, // @@.........@@
+            0,0,0,1,0,0,0,0,0,1,0,0,0, // ...@.....@...
+            0,0,1,0,0,1,0,1,0,0,1,0,0, // ..@..@.@..@..
+            0,1,0,0,1,0,0,0,1,0,0,1,0  // .@..@...@..@.
+        };
+
+        // Player Sprite
+        player_sprite.width = 11;
+        player_sprite.height = 7;
+        player_sprite.data = new uint8_t[11 * 7]{
+            0,0,0,0,0,1,0,0,0,0,0,
+            0,0,0,0,1,1,1,0,0,0,0,
+            0,0,0,0,1,1,1,0,0,0,0,
+            0,1,1,1,1,1,1,1,1,1,0,
+            1,1,1,1,1,1,1,1,1,1,1,
+            1,1,1,1,1,1,1,1,1,1,1,
+            1,1,1,1,1,1,1,1,1,1,1};
+    
+        text_spritesheet.width = 5;
+        text_spritesheet.height = 7;
+        text_spritesheet.data = new uint8_t[65 * 35]
+        {
+            0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+            0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,0,0,0,0,1,0,0,
+            0,1,0,1,0,0,1,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+            0,1,0,1,0,0,1,0,1,0,1,1,1,1,1,0,1,0,1,0,1,1,1,1,1,0,1,0,1,0,0,1,0,1,0,
+            0,0,1,0,0,0,1,1,1,0,1,0,1,0,0,0,1,1,1,0,0,0,1,0,1,0,1,1,1,0,0,0,1,0,0,
+            1,1,0,1,0,1,1,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,1,1,0,1,0,1,1,
+            0,1,1,0,0,1,0,0,1,0,1,0,0,1,0,0,1,1,0,0,1,0,0,1,0,1,0,0,0,1,0,1,1,1,1,
+            0,0,0,1,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+            0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,
+            1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,
+            0,0,1,0,0,1,0,1,0,1,0,1,1,1,0,0,0,1,0,0,0,1,1,1,0,1,0,1,0,1,0,0,1,0,0,
+            0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,1,1,1,1,1,0,0,1,0,0,0,0,1,0,0,0,0,0,0,0,
+            0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,
+            0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+            0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,
+            0,0,0,1,0,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,
+
+            0,1,1,1,0,1,0,0,0,1,1,0,0,1,1,1,0,1,0,1,1,1,0,0,1,1,0,0,0,1,0,1,1,1,0,
+            0,0,1,0,0,0,1,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,1,1,0,
+            0,1,1,1,0,1,0,0,0,1,0,0,0,0,1,0,0,1,1,0,0,1,0,0,0,1,0,0,0,0,1,1,1,1,1,
+            1,1,1,1,1,0,0,0,0,1,0,0,0,1,0,0,0,1,1,0,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
+            0,0,0,1,0,0,0,1,1,0,0,1,0,1,0,1,0,0,1,0,1,1,1,1,1,0,0,0,1,0,0,0,0,1,0,
+            1,1,1,1,1,1,0,0,0,0,1,1,1,1,0,0,0,0,0,1,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
+            0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
+            1,1,1,1,1,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,
+            0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
+            0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,1,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
+
+            0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,
+            0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,
+            0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,
+            0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,0,0,0,0,0,
+            1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,
+            0,1,1,1,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,0,0,0,0,0,1,0,0,
+            0,1,1,1,0,1,0,0,0,1,1,0,1,0,1,1,1,0,1,1,1,0,1,0,0,1,0,0,0,1,0,1,1,1,0,
+
+            0,0,1,0,0,0,1,0,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,1,1,0,0,0,1,1,0,0,0,1,
+            1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,
+            0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,1,1,1,0,
+            1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,
+            1,1,1,1,1,1,0,0,0,0,1,0,0,0,0,1,1,1,1,0,1,0,0,0,0,1,0,0,0,0,1,1,1,1,1,
+            1,1,1,1,1,1,0,0,0,0,1,0,0,0,0,1,1,1,1,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,
+            0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,1,0,1,1,1,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
+            1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,1,1,1,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,
+            0,1,1,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,1,1,0,
+            0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
+            1,0,0,0,1,1,0,0,1,0,1,0,1,0,0,1,1,0,0,0,1,0,1,0,0,1,0,0,1,0,1,0,0,0,1,
+            1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,1,1,1,1,
+            1,0,0,0,1,1,1,0,1,1,1,0,1,0,1,1,0,1,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,
+            1,0,0,0,1,1,0,0,0,1,1,1,0,0,1,1,0,1,0,1,1,0,0,1,1,1,0,0,0,1,1,0,0,0,1,
+            0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
+            1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,
+            0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,1,0,1,1,0,0,1,1,0,1,1,1,1,
+            1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,1,0,1,0,0,1,0,0,1,0,1,0,0,0,1,
+            0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,0,1,1,1,0,1,0,0,0,1,0,0,0,0,1,0,1,1,1,0,
+            1,1,1,1,1,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,
+            1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
+            1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,
+            1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,1,0,1,1,0,1,0,1,1,1,0,1,1,1,0,0,0,1,
+            1,0,0,0,1,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,0,1,0,1,0,1,0,0,0,1,1,0,0,0,1,
+            1,0,0,0,1,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,
+            1,1,1,1,1,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,1,1,1,1,
+
+            0,0,0,1,1,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,1,
+            0,1,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,1,0,
+            1,1,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,1,1,0,0,0,
+            0,0,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+            0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,
+            0,0,1,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
+        };
+
+        number_spritesheet = text_spritesheet;
+        number_spritesheet.data += 16 * 35;
+
+
+        bullet_sprite.width = 1;
+        bullet_sprite.height = 3;
+        bullet_sprite.data = new uint8_t[3]{
+            1,
+            1,
+            1};
+
+        for (size_t i = 0; i < 3; ++i){
+            alien_animation[i].loop = true;
+            alien_animation[i].num_frames = 2;
+            alien_animation[i].frame_duration = 10;
+            alien_animation[i].time = 0;
+
+            alien_animation[i].frames = new Sprite*[2];
+            alien_animation[i].frames[0] = &alien_sprites[2 * i];
+            alien_animation[i].frames[1] = &alien_sprites[2 * i + 1];
+        }
+
+        // Initialiser Game strukten
+        game.width = buffer_width;
+        game.height = buffer_height;
+        game.num_aliens = 55;
+        game.num_bullets = 0;
+        game.aliens = new Alien[game.num_aliens];
+
+        game.player.x = 112 - 5;
+        game.player.y = 32;
+        game.player.life = 3; 
+
+        death_counters = new uint8_t[game.num_aliens];
+        game_spawn_aliens(&game, death_counters, alien_sprites, alien_death_sprite);
+
+        for (size_t i = 0; i < GAME_NUM_BUNKERS; ++i){
+            Bunker& bunker = game.bunkers[i];
+            bunker.x = 32 + 45 * i;
+            bunker.y = 48;
+            memcpy(bunker.rows, bunker_shape, sizeof(bunker.rows));
+        }
+
+        cpu_setup_ms = ms_since(cpu_setup_start);
+    });
+
+    if (run_bench_bunkers){
+        cpu_setup.join();
+        bench_bunkers(game, death_counters, alien_animation,
+                alien_death_sprite, player_sprite, bullet_sprite);
+        return 0;
+    }
+
     // Setter error callback
     glfwSetErrorCallback(error_callback);
 
     // Initialiserer GLFW
+    auto phase_start = std::chrono::steady_clock::now();
     if (!glfwInit()){
         std::cerr << "Failed to initialize GLFW\n"; 
+        cpu_setup.join();
         return -1;
     }
+    const double glfw_ms = ms_since(phase_start);
     
     // Spør om OPENGL 3.3 Core profil
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -119,10 +539,12 @@ int main(){
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 
     // Lager Vinduet
+    phase_start = std::chrono::steady_clock::now();
     GLFWwindow* window = glfwCreateWindow(640, 480, "Space Invaders", NULL, NULL);
     if (!window){
         std::cerr << "Failed to create window...\n";
         glfwTerminate();
+        cpu_setup.join();
         return EXIT_FAILURE;
     }
     glfwSetKeyCallback(window, key_callback);
@@ -132,298 +554,49 @@ int main(){
     
     glfwSwapInterval(1);
 
+    const double window_ms = ms_since(phase_start);
+
     // Initialiserer GLEW
+    phase_start = std::chrono::steady_clock::now();
     glewExperimental = GL_TRUE;
     GLenum err = glewInit();
     if (err != GLEW_OK){
         std::cerr << "GLEW init error: " << glewGetErrorString(err) << std::endl;
         glfwDestroyWindow(window);
         glfwTerminate();
+        cpu_setup.join();
         return EXIT_FAILURE;
     }
-
-    // Lager CPU bufferen
-    const size_t buffer_width  = 224;
-    const size_t buffer_height = 256; 
-    
-    uint32_t clear_color = rgb_to_uint32(0, 0, 0);
-    Buffer buffer;
-    buffer.width  = buffer_width;
-    buffer.height = buffer_height;
-    buffer.data   = new uint32_t[buffer_width * buffer_height];
-    buffer_clear(&buffer, clear_color);
-
-    // Alien Sprite
-    Sprite alien_sprites[6];
-
-    alien_sprites[0].width = 8;
-    alien_sprites[0].height = 8;
-    alien_sprites[0].data = new uint8_t[64]
-    {
-        0,0,0,1,1,0,0,0, // ...@@...
-        0,0,1,1,1,1,0,0, // ..@@@@..
-        0,1,1,1,1,1,1,0, // .@@@@@@.
-        1,1,0,1,1,0,1,1, // @@.@@.@@
-        1,1,1,1,1,1,1,1, // @@@@@@@@
-        0,1,0,1,1,0,1,0, // .@.@@.@.
-        1,0,0,0,0,0,0,1, // @......@
-        0,1,0,0,0,0,1,0  // .@....@.
-    };
-
-    alien_sprites[1].width = 8;
-    alien_sprites[1].height = 8;
-    alien_sprites[1].data = new uint8_t[64]
-    {
-        0,0,0,1,1,0,0,0, // ...@@...
-        0,0,1,1,1,1,0,0, // ..@@@@..
-        0,1,1,1,1,1,1,0, // .@@@@@@.
-        1,1,0,1,1,0,1,1, // @@.@@.@@
-        1,1,1,1,1,1,1,1, // @@@@@@@@
-        0,0,1,0,0,1,0,0, // ..@..@..
-        0,1,0,1,1,0,1,0, // .@.@@.@.
-        1,0,1,0,0,1,0,1  // @.@..@.@
-    };
-
-    alien_sprites[2].width = 11;
-    alien_sprites[2].height = 8;
-    alien_sprites[2].data = new uint8_t[88]
-    {
-        0,0,1,0,0,0,0,0,1,0,0, // ..@.....@..
-        0,0,0,1,0,0,0,1,0,0,0, // ...@...@...
-        0,0,1,1,1,1,1,1,1,0,0, // ..@@@@@@@..
-        0,1,1,0,1,1,1,0,1,1,0, // .@@.@@@.@@.
-        1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@
-        1,0,1,1,1,1,1,1,1,0,1, // @.@@@@@@@.@
-        1,0,1,0,0,0,0,0,1,0,1, // @.@.....@.@
-        0,0,0,1,1,0,1,1,0,0,0  // ...@@.@@...
-    };
-
-    alien_sprites[3].width = 11;
-    alien_sprites[3].height = 8;
-    alien_sprites[3].data = new uint8_t[88]
-    {
-        0,0,1,0,0,0,0,0,1,0,0, // ..@.....@..
-        1,0,0,1,0,0,0,1,0,0,1, // @..@...@..@
-        1,0,1,1,1,1,1,1,1,0,1, // @.@@@@@@@.@
-        1,1,1,0,1,1,1,0,1,1,1, // @@@.@@@.@@@
-        1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@
-        0,1,1,1,1,1,1,1,1,1,0, // .@@@@@@@@@.
-        0,0,1,0,0,0,0,0,1,0,0, // ..@.....@..
-        0,1,0,0,0,0,0,0,0,1,0  // .@.......@.
-    };
-
-    alien_sprites[4].width = 12;
-    alien_sprites[4].height = 8;
-    alien_sprites[4].data = new uint8_t[96]
-    {
-        0,0,0,0,1,1,1,1,0,0,0,0, // ....@@@@....
-        0,1,1,1,1,1,1,1,1,1,1,0, // .@@@@@@@@@@.
-        1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
-        1,1,1,0,0,1,1,0,0,1,1,1, // @@@..@@..@@@
-        1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
-        0,0,0,1,1,0,0,1,1,0,0,0, // ...@@..@@...
-        0,0,1,1,0,1,1,0,1,1,0,0, // ..@@.@@.@@..
-        1,1,0,0,0,0,0,0,0,0,1,1  // @@........@@
-    };
-
-
-    alien_sprites[5].width = 12;
-    alien_sprites[5].height = 8;
-    alien_sprites[5].data = new uint8_t[96]
-    {
-        0,0,0,0,1,1,1,1,0,0,0,0, // ....@@@@....
-        0,1,1,1,1,1,1,1,1,1,1,0, // .@@@@@@@@@@.
-        1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
-        1,1,1,0,0,1,1,0,0,1,1,1, // @@@..@@..@@@
-        1,1,1,1,1,1,1,1,1,1,1,1, // @@@@@@@@@@@@
-        0,0,1,1,1,0,0,1,1,1,0,0, // ..@@@..@@@..
-        0,1,1,0,0,1,1,0,0,1,1,0, // .@@..@@..@@.
-        0,0,1,1,0,0,0,0,1,1,0,0  // ..@@....@@..
-    };
-
-    Sprite alien_death_sprite;
-    alien_death_sprite.width = 13;
-    alien_death_sprite.height = 7;
-    alien_death_sprite.data = new uint8_t[91]
-    {
-        0,1,0,0,1,0,0,0,1,0,0,1,0, // .@..@...@..@.
-        0,0,1,0,0,1,0,1,0,0,1,0,0, // ..@..@.@..@..
-        0,0,0,1,0,0,0,0,0,1,0,0,0, // ...@.....@...
-        1,1,0,0,0,0,0,0,0,0,0,1,1, // @@.........@@
-        0,0,0,1,0,0,0,0,0,1,0,0,0, // ...@.....@...
-        0,0,1,0,0,1,0,1,0,0,1,0,0, // ..@..@.@..@..
-        0,1,0,0,1,0,0,0,1,0,0,1,0  // .@..@...@..@.
-    };
-
-    // Player Sprite
-    Sprite player_sprite;
-    player_sprite.width = 11;
-    player_sprite.height = 7;
-    player_sprite.data = new uint8_t[11 * 7]{
-        0,0,0,0,0,1,0,0,0,0,0,
-        0,0,0,0,1,1,1,0,0,0,0,
-        0,0,0,0,1,1,1,0,0,0,0,
-        0,1,1,1,1,1,1,1,1,1,0,
-        1,1,1,1,1,1,1,1,1,1,1,
-        1,1,1,1,1,1,1,1,1,1,1,
-        1,1,1,1,1,1,1,1,1,1,1};
-    
-    Sprite text_spritesheet;
-    text_spritesheet.width = 5;
-    text_spritesheet.height = 7;
-    text_spritesheet.data = new uint8_t[65 * 35]
-    {
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,0,0,0,0,1,0,0,
-        0,1,0,1,0,0,1,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,1,0,1,0,0,1,0,1,0,1,1,1,1,1,0,1,0,1,0,1,1,1,1,1,0,1,0,1,0,0,1,0,1,0,
-        0,0,1,0,0,0,1,1,1,0,1,0,1,0,0,0,1,1,1,0,0,0,1,0,1,0,1,1,1,0,0,0,1,0,0,
-        1,1,0,1,0,1,1,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,1,1,0,1,0,1,1,
-        0,1,1,0,0,1,0,0,1,0,1,0,0,1,0,0,1,1,0,0,1,0,0,1,0,1,0,0,0,1,0,1,1,1,1,
-        0,0,0,1,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,
-        1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,
-        0,0,1,0,0,1,0,1,0,1,0,1,1,1,0,0,0,1,0,0,0,1,1,1,0,1,0,1,0,1,0,0,1,0,0,
-        0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,1,1,1,1,1,0,0,1,0,0,0,0,1,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,
-        0,0,0,1,0,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,
-
-        0,1,1,1,0,1,0,0,0,1,1,0,0,1,1,1,0,1,0,1,1,1,0,0,1,1,0,0,0,1,0,1,1,1,0,
-        0,0,1,0,0,0,1,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,1,1,0,
-        0,1,1,1,0,1,0,0,0,1,0,0,0,0,1,0,0,1,1,0,0,1,0,0,0,1,0,0,0,0,1,1,1,1,1,
-        1,1,1,1,1,0,0,0,0,1,0,0,0,1,0,0,0,1,1,0,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-        0,0,0,1,0,0,0,1,1,0,0,1,0,1,0,1,0,0,1,0,1,1,1,1,1,0,0,0,1,0,0,0,0,1,0,
-        1,1,1,1,1,1,0,0,0,0,1,1,1,1,0,0,0,0,0,1,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-        0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-        1,1,1,1,1,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,
-        0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-        0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,0,1,1,1,1,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-
-        0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,
-        0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,
-        0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,0,0,0,0,0,
-        1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,
-        0,1,1,1,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,0,0,0,0,0,1,0,0,
-        0,1,1,1,0,1,0,0,0,1,1,0,1,0,1,1,1,0,1,1,1,0,1,0,0,1,0,0,0,1,0,1,1,1,0,
-
-        0,0,1,0,0,0,1,0,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,1,1,0,0,0,1,1,0,0,0,1,
-        1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,
-        0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,0,1,1,1,0,
-        1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,
-        1,1,1,1,1,1,0,0,0,0,1,0,0,0,0,1,1,1,1,0,1,0,0,0,0,1,0,0,0,0,1,1,1,1,1,
-        1,1,1,1,1,1,0,0,0,0,1,0,0,0,0,1,1,1,1,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,
-        0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,1,0,1,1,1,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-        1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,1,1,1,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,
-        0,1,1,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,1,1,1,0,
-        0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-        1,0,0,0,1,1,0,0,1,0,1,0,1,0,0,1,1,0,0,0,1,0,1,0,0,1,0,0,1,0,1,0,0,0,1,
-        1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,1,1,1,1,
-        1,0,0,0,1,1,1,0,1,1,1,0,1,0,1,1,0,1,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,
-        1,0,0,0,1,1,0,0,0,1,1,1,0,0,1,1,0,1,0,1,1,0,0,1,1,1,0,0,0,1,1,0,0,0,1,
-        0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-        1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,
-        0,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,1,0,1,1,0,0,1,1,0,1,1,1,1,
-        1,1,1,1,0,1,0,0,0,1,1,0,0,0,1,1,1,1,1,0,1,0,1,0,0,1,0,0,1,0,1,0,0,0,1,
-        0,1,1,1,0,1,0,0,0,1,1,0,0,0,0,0,1,1,1,0,1,0,0,0,1,0,0,0,0,1,0,1,1,1,0,
-        1,1,1,1,1,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,
-        1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,0,1,1,1,0,
-        1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,
-        1,0,0,0,1,1,0,0,0,1,1,0,0,0,1,1,0,1,0,1,1,0,1,0,1,1,1,0,1,1,1,0,0,0,1,
-        1,0,0,0,1,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,0,1,0,1,0,1,0,0,0,1,1,0,0,0,1,
-        1,0,0,0,1,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,
-        1,1,1,1,1,0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,0,1,1,1,1,1,
-
-        0,0,0,1,1,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,1,
-        0,1,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,0,0,0,0,1,0,
-        1,1,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,1,1,0,0,0,
-        0,0,1,0,0,0,1,0,1,0,1,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,
-        0,0,1,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
-    };
-
-    Sprite number_spritesheet = text_spritesheet;
-    number_spritesheet.data += 16 * 35;
-
-
-    Sprite bullet_sprite;
-    bullet_sprite.width = 1;
-    bullet_sprite.height = 3;
-    bullet_sprite.data = new uint8_t[3]{
-        1,
-        1,
-        1};
-
-    SpriteAnimation alien_animation[3];
-    for (size_t i = 0; i < 3; ++i){
-        alien_animation[i].loop = true;
-        alien_animation[i].num_frames = 2;
-        alien_animation[i].frame_duration = 10;
-        alien_animation[i].time = 0;
-
-        alien_animation[i].frames = new Sprite*[2];
-        alien_animation[i].frames[0] = &alien_sprites[2 * i];
-        alien_animation[i].frames[1] = &alien_sprites[2 * i + 1];
-    }
-
-    // Initialiser Game strukten
-    Game game;
-    game.width = buffer_width;
-    game.height = buffer_height;
-    game.num_aliens = 55;
-    game.num_bullets = 0;
-    game.aliens = new Alien[game.num_aliens];
-
-    game.player.x = 112 - 5;
-    game.player.y = 32;
-    game.player.life = 3; 
-
-    for (size_t yi{0}; yi < 5; ++yi){
-        for (size_t xi{0}; xi < 11; ++xi){
-            Alien& alien = game.aliens[yi * 11 + xi];
-            alien.type = (5 - yi) / 2 + 1;
-
-            const Sprite& sprite = alien_sprites[2 * (alien.type - 1)];
-
-            alien.x = 16 * xi + 20 + (alien_death_sprite.width - sprite.width)/2;
-            alien.y = 17 * yi + 128; 
-        }
-    }
-   
-    uint8_t* death_counters = new uint8_t[game.num_aliens];
-    for (size_t i = 0; i < game.num_aliens; ++i){
-        death_counters[i] = 10;
-    }
+    const double glew_ms = ms_since(phase_start);
 
     //OpenGl objekter
     GLuint vao;
     glGenVertexArrays(1, &vao);
     glBindVertexArray(vao);
 
-    GLuint program = glCreateProgram();
-
-    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vs, 1, &vertex_shader_src, nullptr);
-    glCompileShader(vs);
-    validate_shader(vs, "vertex");
-    glAttachShader(program, vs);
-
-    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fs, 1, &fragment_shader_src, nullptr);
-    glCompileShader(fs);
-    validate_shader(fs, "fragment");
-    glAttachShader(program, fs);
-
-    glLinkProgram(program);
-    validate_program(program);
-
-    glDeleteShader(vs);
-    glDeleteShader(fs);
+    // Shader programmet hentes fra disk cachen hvis driveren godtar det
+    phase_start = std::chrono::steady_clock::now();
+    const char* shader_cache_path = getenv("SPACEINVADERS_SHADER_CACHE");
+    if (!shader_cache_path) shader_cache_path = SHADER_CACHE_DEFAULT_PATH;
+
+    bool shader_cache_hit = false;
+    GLuint program = program_cache_load(shader_cache_path);
+    if (program){
+        shader_cache_hit = true;
+    } else {
+        program = program_compile();
+        program_cache_store(program, shader_cache_path);
+    }
 
     glUseProgram(program);
+    const double shader_ms = ms_since(phase_start);
+
+    // Venter på CPU oppsettet før vi trenger bufferen
+    phase_start = std::chrono::steady_clock::now();
+    cpu_setup.join();
+    const double cpu_setup_wait_ms = ms_since(phase_start);
 
+    phase_start = std::chrono::steady_clock::now();
     GLuint texture;
     glGenTextures(1, &texture);
     glBindTexture(GL_TEXTURE_2D, texture);
@@ -443,13 +616,43 @@ int main(){
     glUniform1i(glGetUniformLocation(program, "buffer"), 0);
 
     glDisable(GL_DEPTH_TEST);
+    const double texture_ms = ms_since(phase_start);
+
+    // Frame server: spillet tegner rett inn i delt minne, så buffer.data byttes hvert frame
+    uint32_t* buffer_storage = buffer.data;
+    FrameServer frame_server = {};
+    if (frame_server_name){
+        if (frame_server_create(&frame_server, frame_server_name, buffer.width, buffer.height)){
+            std::cout << "Frame server at " << frame_server_name << std::endl;
+        } else {
+            int error = errno;
+            std::cerr << "Failed to create frame server " << frame_server_name << ": " << strerror(error);
+            if (error == EEXIST){
+                int32_t owner = frame_server_owner(frame_server_name);
+                std::cerr << " (another running game";
+                if (owner > 0) std::cerr << ", pid " << owner << ",";
+                std::cerr << " is using it)";
+            }
+            std::cerr << std::endl;
+        }
+    }
 
+    Autopilot* autopilot = nullptr;
+    if (use_autopilot){
+        autopilot = autopilot_create(game, alien_death_sprite, player_sprite, bullet_sprite);
+    }
     
     // Spill løkken 
+    phase_start = std::chrono::steady_clock::now();
     size_t score = 0;
     size_t credits = 0;
+    size_t aliens_alive = game.num_aliens;
+    bool first_frame_shown = false;
     game_running = true;
     while (!glfwWindowShouldClose(window) && game_running){
+        if (frame_server.header){
+            buffer.data = frame_server_acquire(&frame_server);
+        }
         buffer_clear(&buffer, clear_color);
        
         buffer_draw_text(&buffer, text_spritesheet, "SCORE",
@@ -477,6 +680,10 @@ int main(){
             }
         }
 
+        for (size_t i = 0; i < GAME_NUM_BUNKERS; ++i){
+            buffer_draw_bunker(&buffer, game.bunkers[i], rgb_to_uint32(0, 255, 0));
+        }
+
         buffer_sprite_draw(&buffer, player_sprite,
                 game.player.x, game.player.y, rgb_to_uint32(255, 255, 255));
         
@@ -487,13 +694,14 @@ int main(){
         }
         
         //----------------------------------------//
-        
-        for (size_t i = 0; i < 3; ++i){
-            ++alien_animation[i].time;
-            if (alien_animation[i].time == alien_animation[i].num_frames * 
-                    alien_animation[i].frame_duration){
-                alien_animation[i].time = 0; 
-            }
+
+        if (frame_server.header){
+            FrameState state = {};
+            state.score = score;
+            state.lives = game.player.life;
+            state.num_aliens = aliens_alive;
+            state.num_bullets = game.num_bullets;
+            frame_server_publish(&frame_server, state);
         }
         
         glTexSubImage2D(
@@ -505,66 +713,31 @@ int main(){
         
         glDrawArrays(GL_TRIANGLES, 0, 3);
         glfwSwapBuffers(window);
-        
-        // Alien Sim
-        for (size_t ai = 0; ai < game.num_aliens; ++ai){
-            const Alien& alien = game.aliens[ai];
-            if (alien.type == ALIEN_DEAD && death_counters[ai]){
-                --death_counters[ai];
-            }
-        }
-        
-        // Bullet Sim
-        for (size_t bi = 0; bi < game.num_bullets;){
-            game.bullets[bi].y += game.bullets[bi].dir;
-            if (game.bullets[bi].y >= game.height || game.bullets[bi].y < bullet_sprite.height){
-                game.bullets[bi] = game.bullets[game.num_bullets - 1];
-                --game.num_bullets;
-                continue;
-            }
 
-            // Sjekk treff
-            for (size_t ai = 0; ai < game.num_aliens; ++ai){
-                const Alien& alien = game.aliens[ai];
-                if (alien.type == ALIEN_DEAD) continue;
-
-                const SpriteAnimation& animation = alien_animation[alien.type - 1];
-                size_t current_frame = animation.time / animation.frame_duration;
-                const Sprite& alien_sprite = *animation.frames[current_frame];
-                bool overlap = sprite_overlap_check(
-                        bullet_sprite, game.bullets[bi].x, game.bullets[bi].y,
-                        alien_sprite, alien.x, alien.y);
-                if (overlap){
-                    score += 10 * (4 - game.aliens[ai].type);
-                    game.aliens[ai].type = ALIEN_DEAD;
-                    game.aliens[ai].x -= (alien_death_sprite.width - alien_sprite.width)/2;
-                    game.bullets[bi] = game.bullets[game.num_bullets - 1];
-                    --game.num_bullets;
-                    continue;
-                }
-            }
-            
-            ++bi;
-        }
-
-        // Bevegelses logikk
-        int player_move_dir = 2 * move_dir;
-        if (player_move_dir != 0){
-            if (game.player.x + player_sprite.width + player_move_dir >= game.width){
-                game.player.x = game.width - player_sprite.width;
-            } else if ((int)game.player.x + player_move_dir <= 0){
-                game.player.x = 0; 
-            } else
-                game.player.x += player_move_dir; 
+        if (!first_frame_shown){
+            first_frame_shown = true;
+            printf("Startup (ms): glfw %.2f, window %.2f, glew %.2f, shaders %.2f (%s), "
+                   "cpu setup %.2f (worker, waited %.2f), textures %.2f, first frame %.2f, total %.2f\n",
+                   glfw_ms, window_ms, glew_ms, shader_ms, shader_cache_hit? "cache hit": "compiled",
+                   cpu_setup_ms, cpu_setup_wait_ms, texture_ms, ms_since(phase_start),
+                   ms_since(startup_start));
         }
         
-        if (fire_pressed && game.num_bullets < GAME_MAX_BULLETS){
-            game.bullets[game.num_bullets].x = game.player.x + player_sprite.width / 2;
-            game.bullets[game.num_bullets].y = game.player.y + player_sprite.height;
-            game.bullets[game.num_bullets].dir = 2;
-            ++game.num_bullets; 
+        // Autopiloten trykker tastene via key_callback, akkurat som en spiller
+        if (autopilot){
+            autopilot_tick(autopilot, window, game, death_counters, alien_animation, score, aliens_alive);
         }
+
+        game_tick(&game, death_counters, alien_animation,
+                alien_death_sprite, player_sprite, bullet_sprite,
+                move_dir, fire_pressed, &score, &aliens_alive);
         fire_pressed = false;
+
+        // Soak testen skal gå i timevis, så autopiloten får en ny bølge når brettet er tomt
+        if (autopilot && aliens_alive == 0){
+            game_spawn_aliens(&game, death_counters, alien_sprites, alien_death_sprite);
+            aliens_alive = game.num_aliens;
+        }
     
         glfwPollEvents();
     }
@@ -575,6 +748,8 @@ int main(){
 
     glDeleteVertexArrays(1, &vao);
 
+    if (autopilot) autopilot_destroy(autopilot);
+
     for (size_t i = 0; i < 6; ++i){
         delete[] alien_sprites[i].data;
     }
@@ -584,6 +759,8 @@ int main(){
     for (size_t i = 0; i < 3; ++i){
         delete[] alien_animation[i].frames;
     }
+    frame_server_destroy(&frame_server);
+    buffer.data = buffer_storage;
     delete[] buffer.data;
     delete[] game.aliens;
     delete[] death_counters;
@@ -591,6 +768,418 @@ int main(){
     return 0;
 }
 
+// Setter opp formasjonen på nytt, brukes ved start og når autopiloten har tømt brettet
+void game_spawn_aliens(Game* game, uint8_t* death_counters, const Sprite* alien_sprites, const Sprite& alien_death_sprite){
+    for (size_t yi{0}; yi < 5; ++yi){
+        for (size_t xi{0}; xi < 11; ++xi){
+            Alien& alien = game->aliens[yi * 11 + xi];
+            alien.type = (5 - yi) / 2 + 1;
+
+            const Sprite& sprite = alien_sprites[2 * (alien.type - 1)];
+
+            alien.x = 16 * xi + 20 + (alien_death_sprite.width - sprite.width)/2;
+            alien.y = 17 * yi + 128; 
+        }
+    }
+
+    for (size_t i = 0; i < game->num_aliens; ++i){
+        death_counters[i] = 10;
+    }
+}
+
+// Ett tick av spillet. Allokerer ingenting, så autopiloten kan kjøre den på kopier.
+void game_tick(
+        Game* game, uint8_t* death_counters, SpriteAnimation* alien_animation,
+        const Sprite& alien_death_sprite, const Sprite& player_sprite, const Sprite& bullet_sprite,
+        int move_dir, bool fire, size_t* score, size_t* aliens_alive)
+{
+    for (size_t i = 0; i < 3; ++i){
+        ++alien_animation[i].time;
+        if (alien_animation[i].time == alien_animation[i].num_frames * 
+                alien_animation[i].frame_duration){
+            alien_animation[i].time = 0; 
+        }
+    }
+
+    // Alien Sim
+    for (size_t ai = 0; ai < game->num_aliens; ++ai){
+        const Alien& alien = game->aliens[ai];
+        if (alien.type == ALIEN_DEAD && death_counters[ai]){
+            --death_counters[ai];
+        }
+    }
+    
+    // Bullet Sim
+    for (size_t bi = 0; bi < game->num_bullets;){
+        game->bullets[bi].y += game->bullets[bi].dir;
+        if (game->bullets[bi].y >= game->height || game->bullets[bi].y < bullet_sprite.height){
+            game->bullets[bi] = game->bullets[game->num_bullets - 1];
+            --game->num_bullets;
+            continue;
+        }
+
+        // Sjekk treff i bunkerne
+        bool bunker_hit = false;
+        for (size_t i = 0; i < GAME_NUM_BUNKERS && !bunker_hit; ++i){
+            bunker_hit = bunker_bullet_hit(&game->bunkers[i], bullet_sprite, game->bullets[bi]);
+        }
+        if (bunker_hit){
+            game->bullets[bi] = game->bullets[game->num_bullets - 1];
+            --game->num_bullets;
+            continue;
+        }
+
+        // Sjekk treff
+        for (size_t ai = 0; ai < game->num_aliens; ++ai){
+            const Alien& alien = game->aliens[ai];
+            if (alien.type == ALIEN_DEAD) continue;
+
+            const SpriteAnimation& animation = alien_animation[alien.type - 1];
+            size_t current_frame = animation.time / animation.frame_duration;
+            const Sprite& alien_sprite = *animation.frames[current_frame];
+            bool overlap = sprite_overlap_check(
+                    bullet_sprite, game->bullets[bi].x, game->bullets[bi].y,
+                    alien_sprite, alien.x, alien.y);
+            if (overlap){
+                *score += 10 * (4 - game->aliens[ai].type);
+                game->aliens[ai].type = ALIEN_DEAD;
+                --*aliens_alive;
+                game->aliens[ai].x -= (alien_death_sprite.width - alien_sprite.width)/2;
+                game->bullets[bi] = game->bullets[game->num_bullets - 1];
+                --game->num_bullets;
+                continue;
+            }
+        }
+        
+        ++bi;
+    }
+
+    // Bevegelses logikk
+    int player_move_dir = 2 * move_dir;
+    if (player_move_dir != 0){
+        if (game->player.x + player_sprite.width + player_move_dir >= game->width){
+            game->player.x = game->width - player_sprite.width;
+        } else if ((int)game->player.x + player_move_dir <= 0){
+            game->player.x = 0; 
+        } else
+            game->player.x += player_move_dir; 
+    }
+    
+    if (fire && game->num_bullets < GAME_MAX_BULLETS){
+        game->bullets[game->num_bullets].x = game->player.x + player_sprite.width / 2;
+        game->bullets[game->num_bullets].y = game->player.y + player_sprite.height;
+        game->bullets[game->num_bullets].dir = 2;
+        ++game->num_bullets; 
+    }
+}
+
+// Treffer skuddet en intakt piksel bites et krater ut rundt treffpunktet
+bool bunker_bullet_hit(Bunker* bunker, const Sprite& bullet_sprite, const Bullet& bullet){
+    const Sprite bunker_sprite = {BUNKER_WIDTH, BUNKER_HEIGHT, nullptr};
+    if (!sprite_overlap_check(
+            bullet_sprite, bullet.x, bullet.y,
+            bunker_sprite, bunker->x, bunker->y)){
+        return false;
+    }
+
+    // Kolonnene skuddet dekker, som en maske i bunkerens koordinater
+    const long col = (long)bullet.x - (long)bunker->x;
+    const uint32_t bullet_bits = (1u << bullet_sprite.width) - 1;
+    const uint32_t mask = col >= 0? bullet_bits << col: bullet_bits >> -col;
+
+    // Radene sjekkes i den retningen skuddet kommer fra
+    const size_t y_min = bullet.y > bunker->y? bullet.y: bunker->y;
+    const size_t y_max = bullet.y + bullet_sprite.height < bunker->y + BUNKER_HEIGHT?
+        bullet.y + bullet_sprite.height: bunker->y + BUNKER_HEIGHT;
+    for (size_t i = 0; i < y_max - y_min; ++i){
+        size_t sy = bullet.dir > 0? y_min + i: y_max - 1 - i;
+        size_t row = bunker->y + BUNKER_HEIGHT - 1 - sy;
+        if (bunker->rows[row] & mask){
+            bunker_carve(bunker, col + bullet_sprite.width / 2, row);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void bunker_carve(Bunker* bunker, long col, long row){
+    const long left = col - BUNKER_CRATER_WIDTH / 2;
+    const long top  = row - BUNKER_CRATER_HEIGHT / 2;
+    for (long ci = 0; ci < BUNKER_CRATER_HEIGHT; ++ci){
+        long r = top + ci;
+        if (r < 0 || r >= BUNKER_HEIGHT) continue;
+
+        uint32_t crater = left >= 0? bunker_crater[ci] << left: bunker_crater[ci] >> -left;
+        bunker->rows[r] &= ~crater;
+    }
+}
+
+/* =====================
+     AUTOPILOT
+   =====================
+   Hvert tick kopieres spillet, og hver handling (venstre/stå/høyre, med
+   eller uten skudd) rulles ut AUTOPILOT_ROLLOUTS ganger på tvers av trådene.
+   Bevegelsen holdes en tilfeldig stund før spilleren stopper, og skuddene
+   etter første tick er tilfeldige.
+   Handlingen med mest poeng i snitt sendes inn via key_callback. Når
+   brettet er tomt setter main opp en ny bølge, så autopiloten spiller videre.
+*/
+
+uint64_t autopilot_random(uint64_t* state){
+    // xorshift64
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+void autopilot_worker_init(AutopilotWorker* worker, size_t num_aliens){
+    worker->aliens = new Alien[num_aliens];
+    worker->death_counters = new uint8_t[num_aliens];
+}
+
+Autopilot* autopilot_create(
+        const Game& game,
+        const Sprite& alien_death_sprite, const Sprite& player_sprite, const Sprite& bullet_sprite)
+{
+    Autopilot* autopilot = new Autopilot();
+    autopilot->game = game;
+    autopilot->game.aliens = new Alien[game.num_aliens];
+    autopilot->death_counters = new uint8_t[game.num_aliens];
+    autopilot->fire_cooldown = 0;
+
+    autopilot->alien_death_sprite = &alien_death_sprite;
+    autopilot->player_sprite = &player_sprite;
+    autopilot->bullet_sprite = &bullet_sprite;
+
+    autopilot->generation = 0;
+    autopilot->workers_busy = 0;
+    autopilot->quit = false;
+    autopilot->held_move = 0;
+    autopilot->rollouts = 0;
+    autopilot->report_rollouts = 0;
+    autopilot->ticks.store(0);
+    autopilot->report_ticks = 0;
+    autopilot->start_time = std::chrono::steady_clock::now();
+    autopilot->report_time = autopilot->start_time;
+
+    size_t num_threads = std::thread::hardware_concurrency();
+    autopilot->num_workers = num_threads > 1? num_threads - 1: 0;
+
+    autopilot_worker_init(&autopilot->main_worker, game.num_aliens);
+    autopilot->workers = new AutopilotWorker[autopilot->num_workers];
+    for (size_t i = 0; i < autopilot->num_workers; ++i){
+        AutopilotWorker* worker = &autopilot->workers[i];
+        autopilot_worker_init(worker, game.num_aliens);
+        worker->thread = std::thread(autopilot_worker, autopilot, worker);
+    }
+
+    std::cout << "Autopilot on, " << autopilot->num_workers + 1 << " threads" << std::endl;
+    return autopilot;
+}
+
+void autopilot_destroy(Autopilot* autopilot){
+    {
+        std::lock_guard<std::mutex> lock(autopilot->mutex);
+        autopilot->quit = true;
+    }
+    autopilot->start.notify_all();
+
+    for (size_t i = 0; i < autopilot->num_workers; ++i){
+        autopilot->workers[i].thread.join();
+        delete[] autopilot->workers[i].aliens;
+        delete[] autopilot->workers[i].death_counters;
+    }
+    delete[] autopilot->workers;
+    delete[] autopilot->main_worker.aliens;
+    delete[] autopilot->main_worker.death_counters;
+
+    double seconds = ms_since(autopilot->start_time) / 1000.0;
+    if (seconds > 0){
+        printf("Autopilot: %llu rollouts, %.0f rollouts/s, %.0f ticks/s simulated\n",
+               (unsigned long long)autopilot->rollouts, autopilot->rollouts / seconds,
+               autopilot->ticks.load() / seconds);
+    }
+
+    delete[] autopilot->game.aliens;
+    delete[] autopilot->death_counters;
+    delete autopilot;
+}
+
+void autopilot_worker(Autopilot* autopilot, AutopilotWorker* worker){
+    uint64_t generation = 0;
+    for (;;){
+        {
+            std::unique_lock<std::mutex> lock(autopilot->mutex);
+            autopilot->start.wait(lock, [&]{
+                return autopilot->quit || autopilot->generation != generation;
+            });
+            if (autopilot->quit) return;
+            generation = autopilot->generation;
+        }
+
+        const size_t total = AUTOPILOT_ACTIONS * AUTOPILOT_ROLLOUTS;
+        for (size_t r = autopilot->next_rollout++; r < total; r = autopilot->next_rollout++){
+            autopilot_rollout(autopilot, worker, r);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(autopilot->mutex);
+            if (--autopilot->workers_busy == 0) autopilot->done.notify_one();
+        }
+    }
+}
+
+void autopilot_rollout(Autopilot* autopilot, AutopilotWorker* worker, size_t rollout){
+    const size_t action = rollout % AUTOPILOT_ACTIONS;
+
+    Game game = autopilot->game;
+    game.aliens = worker->aliens;
+    memcpy(game.aliens, autopilot->game.aliens, game.num_aliens * sizeof(Alien));
+    uint8_t* death_counters = worker->death_counters;
+    memcpy(death_counters, autopilot->death_counters, game.num_aliens);
+
+    SpriteAnimation alien_animation[3];
+    for (size_t i = 0; i < 3; ++i){
+        alien_animation[i] = autopilot->alien_animation[i];
+    }
+
+    size_t score = autopilot->score;
+    size_t aliens_alive = autopilot->aliens_alive;
+    size_t fire_cooldown = autopilot->fire_cooldown;
+
+    // Samme tilfeldige tall for alle handlingene i en gruppe, så forskjellen
+    // mellom dem kommer fra handlingen og ikke fra støy
+    uint64_t rng = (autopilot->generation * AUTOPILOT_ROLLOUTS + rollout / AUTOPILOT_ACTIONS + 1) *
+        0x9E3779B97F4A7C15ull;
+
+    int move = (int)(action % AUTOPILOT_MOVES) - 1;
+    const size_t hold = 1 + autopilot_random(&rng) % AUTOPILOT_HORIZON;
+    size_t t = 0;
+    for (; t < AUTOPILOT_HORIZON && aliens_alive > 0; ++t){
+        bool fire = action >= AUTOPILOT_MOVES;
+        if (t > 0){
+            if (t == hold) move = 0;
+            fire = autopilot_random(&rng) % 4 == 0;
+        }
+
+        fire = fire && fire_cooldown == 0;
+        if (fire) fire_cooldown = AUTOPILOT_FIRE_INTERVAL;
+        else if (fire_cooldown) --fire_cooldown;
+
+        game_tick(&game, death_counters, alien_animation,
+                *autopilot->alien_death_sprite, *autopilot->player_sprite, *autopilot->bullet_sprite,
+                move, fire, &score, &aliens_alive);
+    }
+
+    autopilot->ticks.fetch_add(t, std::memory_order_relaxed);
+
+    // Poeng teller mest, ellers er det bedre å stå under en alien enn langt unna
+    size_t distance = game.width;
+    const size_t player_center = game.player.x + autopilot->player_sprite->width / 2;
+    for (size_t ai = 0; ai < game.num_aliens; ++ai){
+        const Alien& alien = game.aliens[ai];
+        if (alien.type == ALIEN_DEAD) continue;
+
+        const size_t alien_center = alien.x + autopilot->alien_death_sprite->width / 2;
+        const size_t d = alien_center > player_center? alien_center - player_center: player_center - alien_center;
+        if (d < distance) distance = d;
+    }
+
+    autopilot->action_score[action].fetch_add(
+            (score - autopilot->score) * game.width + game.width - distance,
+            std::memory_order_relaxed);
+}
+
+void autopilot_tick(
+        Autopilot* autopilot, GLFWwindow* window,
+        const Game& game, const uint8_t* death_counters, const SpriteAnimation* alien_animation,
+        size_t score, size_t aliens_alive)
+{
+    // Kopier spillet inn i roten, uten å allokere
+    Alien* aliens = autopilot->game.aliens;
+    autopilot->game = game;
+    autopilot->game.aliens = aliens;
+    memcpy(aliens, game.aliens, game.num_aliens * sizeof(Alien));
+    memcpy(autopilot->death_counters, death_counters, game.num_aliens);
+    for (size_t i = 0; i < 3; ++i){
+        autopilot->alien_animation[i] = alien_animation[i];
+    }
+    autopilot->score = score;
+    autopilot->aliens_alive = aliens_alive;
+
+    for (size_t a = 0; a < AUTOPILOT_ACTIONS; ++a){
+        autopilot->action_score[a].store(0, std::memory_order_relaxed);
+    }
+    autopilot->next_rollout.store(0);
+
+    {
+        std::lock_guard<std::mutex> lock(autopilot->mutex);
+        autopilot->workers_busy = autopilot->num_workers;
+        ++autopilot->generation;
+    }
+    autopilot->start.notify_all();
+
+    const size_t total = AUTOPILOT_ACTIONS * AUTOPILOT_ROLLOUTS;
+    for (size_t r = autopilot->next_rollout++; r < total; r = autopilot->next_rollout++){
+        autopilot_rollout(autopilot, &autopilot->main_worker, r);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(autopilot->mutex);
+        autopilot->done.wait(lock, [&]{ return autopilot->workers_busy == 0; });
+    }
+
+    // Best snitt vinner. Uavgjort går til skudd når det er lov, ellers til å stå stille.
+    const bool can_fire = autopilot->fire_cooldown == 0;
+    size_t best = can_fire? AUTOPILOT_MOVES + 1: 1;
+    size_t best_score = autopilot->action_score[best].load(std::memory_order_relaxed);
+    for (size_t a = 0; a < AUTOPILOT_ACTIONS; ++a){
+        size_t action_score = autopilot->action_score[a].load(std::memory_order_relaxed);
+        if (action_score > best_score ||
+                (action_score == best_score && can_fire &&
+                 a >= AUTOPILOT_MOVES && best < AUTOPILOT_MOVES)){
+            best = a;
+            best_score = action_score;
+        }
+    }
+
+    // Samme vei inn som tastaturet
+    int move = (int)(best % AUTOPILOT_MOVES) - 1;
+    if (move != autopilot->held_move){
+        if (autopilot->held_move < 0) key_callback(window, GLFW_KEY_LEFT, 0, GLFW_RELEASE, 0);
+        if (autopilot->held_move > 0) key_callback(window, GLFW_KEY_RIGHT, 0, GLFW_RELEASE, 0);
+        if (move < 0) key_callback(window, GLFW_KEY_LEFT, 0, GLFW_PRESS, 0);
+        if (move > 0) key_callback(window, GLFW_KEY_RIGHT, 0, GLFW_PRESS, 0);
+        autopilot->held_move = move;
+    }
+
+    bool fire = best >= AUTOPILOT_MOVES && can_fire;
+    if (fire){
+        key_callback(window, GLFW_KEY_SPACE, 0, GLFW_PRESS, 0);
+        key_callback(window, GLFW_KEY_SPACE, 0, GLFW_RELEASE, 0);
+        autopilot->fire_cooldown = AUTOPILOT_FIRE_INTERVAL;
+    } else if (autopilot->fire_cooldown){
+        --autopilot->fire_cooldown;
+    }
+
+    autopilot->rollouts += total;
+    double seconds = ms_since(autopilot->report_time) / 1000.0;
+    if (seconds >= AUTOPILOT_REPORT_SECONDS){
+        const uint64_t ticks = autopilot->ticks.load(std::memory_order_relaxed);
+        printf("Autopilot: %.0f rollouts/s (%.0f ticks/s simulated), score %zu\n",
+               (autopilot->rollouts - autopilot->report_rollouts) / seconds,
+               (ticks - autopilot->report_ticks) / seconds,
+               score);
+        autopilot->report_rollouts = autopilot->rollouts;
+        autopilot->report_ticks = ticks;
+        autopilot->report_time = std::chrono::steady_clock::now();
+    }
+}
+
 void error_callback(int error, const char* description){
     fprintf(stderr, "Error: %s\n", description);
 }
@@ -640,6 +1229,246 @@ bool validate_program(GLuint program){
     return true;
 }
 
+// glProgramBinary og venner finnes bare med GL 4.1 eller ARB_get_program_binary,
+// ellers er pekerne fra GLEW null
+bool program_binary_supported(){
+    if (!GLEW_ARB_get_program_binary && !GLEW_VERSION_4_1) return false;
+
+    GLint num_formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+    return num_formats > 0;
+}
+
+GLuint program_compile(){
+    GLuint program = glCreateProgram();
+
+    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vs, 1, &vertex_shader_src, nullptr);
+    glCompileShader(vs);
+    validate_shader(vs, "vertex");
+    glAttachShader(program, vs);
+
+    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fs, 1, &fragment_shader_src, nullptr);
+    glCompileShader(fs);
+    validate_shader(fs, "fragment");
+    glAttachShader(program, fs);
+
+    // Må settes før linking for at glGetProgramBinary skal gi noe
+    if (program_binary_supported()){
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(program);
+    validate_program(program);
+
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    return program;
+}
+
+// Binæren gjelder bare for samme driver og samme shader kilde
+std::string program_cache_key(){
+    uint64_t hash = 14695981039346656037ull;
+    for (const char* src: {vertex_shader_src, fragment_shader_src}){
+        for (const char* c = src; *c != '\0'; ++c){
+            hash = (hash ^ (uint8_t)*c) * 1099511628211ull;
+        }
+    }
+
+    std::string key;
+    key += (const char*)glGetString(GL_VENDOR);
+    key += '\n';
+    key += (const char*)glGetString(GL_RENDERER);
+    key += '\n';
+    key += (const char*)glGetString(GL_VERSION);
+    key += '\n';
+    key += std::to_string(hash);
+    return key;
+}
+
+GLuint program_cache_load(const char* path){
+    if (!program_binary_supported()) return 0;
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+
+    const std::string key = program_cache_key();
+    uint32_t header[2] = {0, 0};
+    uint32_t format_length[2] = {0, 0};
+    std::string file_key;
+    char* binary = nullptr;
+    bool ok = fread(header, sizeof(header), 1, file) == 1 &&
+            header[0] == SHADER_CACHE_MAGIC && header[1] == key.size();
+    if (ok){
+        file_key.resize(header[1]);
+        ok = fread(&file_key[0], 1, header[1], file) == header[1] && file_key == key &&
+                fread(format_length, sizeof(format_length), 1, file) == 1 && format_length[1] > 0;
+    }
+    if (ok){
+        // Binæren er resten av fila. En ødelagt lengde skal gi cache miss,
+        // ikke en allokering på flere GiB
+        long start = ftell(file);
+        ok = start >= 0 && fseek(file, 0, SEEK_END) == 0;
+        long end = ok ? ftell(file) : -1;
+        ok = ok && end >= start && (unsigned long)(end - start) == format_length[1] &&
+                fseek(file, start, SEEK_SET) == 0;
+    }
+    if (ok){
+        binary = new char[format_length[1]];
+        ok = fread(binary, 1, format_length[1], file) == format_length[1];
+    }
+    fclose(file);
+
+    if (!ok){
+        delete[] binary;
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, format_length[0], binary, format_length[1]);
+    delete[] binary;
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE){
+        std::cout << "Shader cache rejected by driver, compiling from source" << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+void program_cache_store(GLuint program, const char* path){
+    if (!program_binary_supported()) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    char* binary = new char[length];
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary);
+
+    // Skriv til en midlertidig fil per prosess og bytt om, så en annen instans
+    // aldri leser en halv fil, selv om flere skriver cachen samtidig
+    const std::string key = program_cache_key();
+    const std::string tmp_path = std::string(path) + "." + std::to_string(getpid()) + ".tmp";
+    uint32_t header[2] = {SHADER_CACHE_MAGIC, (uint32_t)key.size()};
+    uint32_t format_length[2] = {format, (uint32_t)length};
+
+    FILE* file = fopen(tmp_path.c_str(), "wb");
+    if (file){
+        bool ok = fwrite(header, sizeof(header), 1, file) == 1 &&
+                fwrite(key.data(), 1, key.size(), file) == key.size() &&
+                fwrite(format_length, sizeof(format_length), 1, file) == 1 &&
+                fwrite(binary, 1, length, file) == (size_t)length;
+        ok = fclose(file) == 0 && ok;
+
+        if (!ok || rename(tmp_path.c_str(), path) != 0){
+            remove(tmp_path.c_str());
+        }
+    }
+
+    delete[] binary;
+}
+
+double ms_since(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Måler hva bunkerne koster i et tick med GAME_MAX_BULLETS skudd:
+//  - game_tick med skuddene i fri flukt (vanlig alien sjekk per skudd)
+//  - bunker sjekken alene, der hvert skudd treffer intakt bunker
+//  - bunker sjekken alene, med bunkerne flyttet ut av veien (bare early-out)
+// En bunker settes tilbake rett etter hvert treff, så neste skudd også treffer
+// hel bunker. Den kopien er med i tiden, så treff tallet er en øvre grense.
+void bench_bunkers(
+        const Game& game, const uint8_t* death_counters, const SpriteAnimation* alien_animation,
+        const Sprite& alien_death_sprite, const Sprite& player_sprite, const Sprite& bullet_sprite)
+{
+    const size_t rounds = 20000;
+
+    // Ett skudd per kolonne rundt om på bunkerne, høyden forskjøvet innenfor
+    // de helt fylte radene 4-11
+    Bullet bullets[GAME_MAX_BULLETS];
+    for (size_t bi = 0; bi < GAME_MAX_BULLETS; ++bi){
+        const Bunker& bunker = game.bunkers[bi % GAME_NUM_BUNKERS];
+        size_t k = bi / GAME_NUM_BUNKERS;
+        bullets[bi].x = bunker.x + k % BUNKER_WIDTH;
+        bullets[bi].y = bunker.y + 4 + k % 6;
+        bullets[bi].dir = 2;
+    }
+
+    // game_tick med de samme skuddene, bunkerne ute av veien
+    Game bench = game;
+    bench.aliens = new Alien[game.num_aliens];
+    memcpy(bench.aliens, game.aliens, game.num_aliens * sizeof(Alien));
+    uint8_t* bench_death_counters = new uint8_t[game.num_aliens];
+    memcpy(bench_death_counters, death_counters, game.num_aliens);
+    SpriteAnimation bench_animation[3];
+    for (size_t i = 0; i < 3; ++i){
+        bench_animation[i] = alien_animation[i];
+    }
+    for (size_t i = 0; i < GAME_NUM_BUNKERS; ++i){
+        bench.bunkers[i].x += game.width;
+    }
+
+    double tick_ms = 0;
+    for (size_t round = 0; round < rounds; ++round){
+        memcpy(bench.bullets, bullets, sizeof(bullets));
+        bench.num_bullets = GAME_MAX_BULLETS;
+
+        size_t score = 0;
+        size_t aliens_alive = game.num_aliens;
+        const auto start = std::chrono::steady_clock::now();
+        game_tick(&bench, bench_death_counters, bench_animation,
+                alien_death_sprite, player_sprite, bullet_sprite,
+                0, false, &score, &aliens_alive);
+        tick_ms += ms_since(start);
+    }
+
+    // Bunker sjekken slik game_tick gjør den, treff og bom
+    double pass_ms[2] = {0, 0};
+    size_t pass_hits[2] = {0, 0};
+    for (int in_path = 1; in_path >= 0; --in_path){
+        Bunker bunkers[GAME_NUM_BUNKERS];
+        for (size_t i = 0; i < GAME_NUM_BUNKERS; ++i){
+            bunkers[i] = game.bunkers[i];
+            if (!in_path) bunkers[i].x += game.width;
+        }
+
+        for (size_t round = 0; round < rounds; ++round){
+            size_t hits = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t bi = 0; bi < GAME_MAX_BULLETS; ++bi){
+                for (size_t i = 0; i < GAME_NUM_BUNKERS; ++i){
+                    if (bunker_bullet_hit(&bunkers[i], bullet_sprite, bullets[bi])){
+                        memcpy(bunkers[i].rows, game.bunkers[i].rows, sizeof(bunkers[i].rows));
+                        ++hits;
+                        break;
+                    }
+                }
+            }
+            pass_ms[in_path] += ms_since(start);
+            pass_hits[in_path] += hits;
+        }
+    }
+
+    const double tick_us = tick_ms * 1000 / rounds;
+    printf("game_tick, %d bullets in free flight: %.3f us/tick\n", GAME_MAX_BULLETS, tick_us);
+    printf("bunker pass, bullets into bunkers:   %.3f us/tick (%.1f%% of the tick), %zu of %d hit\n",
+           pass_ms[1] * 1000 / rounds, 100 * pass_ms[1] * 1000 / rounds / tick_us,
+           pass_hits[1] / rounds, GAME_MAX_BULLETS);
+    printf("bunker pass, bunkers out of path:    %.3f us/tick (%.1f%% of the tick), %zu of %d hit\n",
+           pass_ms[0] * 1000 / rounds, 100 * pass_ms[0] * 1000 / rounds / tick_us,
+           pass_hits[0] / rounds, GAME_MAX_BULLETS);
+
+    delete[] bench.aliens;
+    delete[] bench_death_counters;
+}
+
 bool sprite_overlap_check(
         const Sprite& sp_a, size_t x_a, size_t y_a,
         const Sprite& sp_b, size_t x_b, size_t y_b){
@@ -677,6 +1506,20 @@ void buffer_sprite_draw(Buffer* buffer, const Sprite& sprite, size_t x, size_t y
     }
 }
 
+void buffer_draw_bunker(Buffer* buffer, const Bunker& bunker, uint32_t color){
+    for (size_t row = 0; row < BUNKER_HEIGHT; ++row){
+        size_t sy = bunker.y + BUNKER_HEIGHT - 1 - row;
+        if (sy >= buffer->height) continue;
+
+        // Bare de satte bitene besøkes
+        uint32_t* dst = buffer->data + sy * buffer->width + bunker.x;
+        for (uint32_t bits = bunker.rows[row]; bits; bits &= bits - 1){
+            size_t xi = __builtin_ctz(bits);
+            if (bunker.x + xi < buffer->width) dst[xi] = color;
+        }
+    }
+}
+
 void buffer_draw_text(
         Buffer* buffer,
         const Sprite& text_spritesheet,